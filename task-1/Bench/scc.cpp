@@ -0,0 +1,92 @@
+//Сравнение последовательного Тарьяна и параллельного forward-backward из scc.h
+//на длинной цепочке, цепочке 2-циклов, наборе треугольников и случайном разреженном графе.
+//Сборка: g++ -O2 -std=c++17 -pthread scc.cpp -o scc
+//Запуск: ./scc [кол-во вершин] [потоки]
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include "../Graph/scc.h"
+
+//ListGraph неориентированный, а MatrixGraph на таких V не влезет в память, поэтому свой орграф на списках
+class DirectedGraph : public IGraph<> {
+public:
+    explicit DirectedGraph(size_t verticesCount) : vertices(verticesCount) {}
+
+    void AddEdge(uint32_t from, uint32_t to) override {
+        vertices.at(from).push_back(to);
+    }
+
+    size_t VerticesCount() const override {
+        return vertices.size();
+    }
+
+    std::vector<uint32_t> GetVertices(uint32_t vertex) const override {
+        return vertices.at(vertex);
+    }
+private:
+    std::vector<std::vector<uint32_t>> vertices;
+};
+
+template <typename F>
+long long milliseconds(F f) {
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+}
+
+void run(const std::string& name, const DirectedGraph& graph, size_t threads) {
+    size_t tarjanCount = 0, oneCount = 0, manyCount = 0;
+    std::cout << name << "\n";
+    std::cout << "  Tarjan: " << milliseconds([&] {
+        tarjanCount = stronglyConnectedComponents(&graph).componentsCount;
+    }) << " ms\n";
+    std::cout << "  forward-backward, 1 thread: " << milliseconds([&] {
+        oneCount = parallelStronglyConnectedComponents(&graph, 1).componentsCount;
+    }) << " ms\n";
+    std::cout << "  forward-backward, " << threads << " threads: " << milliseconds([&] {
+        manyCount = parallelStronglyConnectedComponents(&graph, threads).componentsCount;
+    }) << " ms\n";
+    if(oneCount != tarjanCount || manyCount != tarjanCount) {
+        std::cout << "  MISMATCH: " << tarjanCount << " " << oneCount << " " << manyCount << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 200000;
+    size_t threads = argc > 2 ? std::stoul(argv[2]) : std::thread::hardware_concurrency();
+
+    DirectedGraph chain(n);
+    for(uint32_t v = 0; v + 1 < n; ++v) {
+        chain.AddEdge(v, v + 1);
+    }
+    run("chain, V = " + std::to_string(n), chain, threads);
+
+    //подрезка тут ничего не снимает, а опорная вершина с края отщепляет от задачи только один 2-цикл
+    DirectedGraph pairs(n);
+    for(uint32_t v = 0; v + 1 < n; ++v) {
+        pairs.AddEdge(v, v + 1);
+        if(v % 2 == 0) {
+            pairs.AddEdge(v + 1, v);
+        }
+    }
+    run("chain of 2-cycles, V = " + std::to_string(n), pairs, threads);
+
+    DirectedGraph triangles(n);
+    for(uint32_t v = 0; v + 2 < n; v += 3) {
+        triangles.AddEdge(v, v + 1);
+        triangles.AddEdge(v + 1, v + 2);
+        triangles.AddEdge(v + 2, v);
+    }
+    run("disjoint triangles, V = " + std::to_string(n), triangles, threads);
+
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<uint32_t> vertex(0, n - 1);
+    DirectedGraph sparse(n);
+    for(size_t i = 0; i < n * 3 / 2; ++i) {
+        sparse.AddEdge(vertex(gen), vertex(gen));
+    }
+    run("random, V = " + std::to_string(n) + ", E = 1.5V", sparse, threads);
+    return 0;
+}
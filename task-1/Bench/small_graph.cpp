@@ -0,0 +1,59 @@
+//Где битовые ядра FixedGraph обгоняют обычные hasCycle / isBipartite на графах, заданных через IGraph.
+//По результатам выставляются пороги HAS_CYCLE_FIXED_MAX_VERTICES и IS_BIPARTITE_FIXED_MAX_VERTICES в graph.h.
+//Сборка: g++ -O2 -std=c++17 small_graph.cpp -o small_graph
+//Запуск: ./small_graph [кол-во повторов]
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <string>
+#include "../Graph/graph.h"
+
+template <typename F>
+double microseconds(size_t repeats, F f) {
+    volatile size_t sink = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < repeats; ++i) {
+        sink = sink + f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - begin).count() / repeats;
+}
+
+template <size_t N>
+void compare(size_t n, size_t repeats) {
+    MatrixGraph<> chain(n);         //ацикличная цепочка - худший случай для hasCycle
+    ListGraph<> path(n);            //путь - двудольный, обходится целиком
+    MatrixGraph<> random(n);        //случайный орграф со средней степенью 2
+    std::mt19937 gen(n);
+    for(uint32_t v = 0; v + 1 < n; ++v) {
+        chain.AddEdge(v, v + 1);
+        path.AddEdge(v, v + 1);
+    }
+    for(size_t i = 0; i < 2 * n; ++i) {
+        uint32_t from = gen() % n, to = gen() % n;
+        if(from < to) {
+            random.AddEdge(from, to);
+        }
+    }
+    std::cout << "n = " << n << "\n";
+    std::cout << "  hasCycle chain:      dfs " << microseconds(repeats, [&] { return hasCycleDfs(&chain); })
+              << " us, fixed " << microseconds(repeats, [&] { return toFixedGraph<N>(&chain).HasCycle(); }) << " us\n";
+    std::cout << "  hasCycle random DAG: dfs " << microseconds(repeats, [&] { return hasCycleDfs(&random); })
+              << " us, fixed " << microseconds(repeats, [&] { return toFixedGraph<N>(&random).HasCycle(); }) << " us\n";
+    std::cout << "  isBipartite path:    bfs " << microseconds(repeats, [&] { return isBipartiteBfs(&path).size(); })
+              << " us, fixed " << microseconds(repeats, [&] {
+                  return size_t(toFixedGraphFrom<N>(&path, uint32_t(0)).IsBipartite(0));
+              }) << " us\n";
+}
+
+int main(int argc, char** argv) {
+    size_t repeats = argc > 1 ? std::stoul(argv[1]) : 2000;
+    compare<64>(8, repeats);
+    compare<64>(16, repeats);
+    compare<64>(32, repeats);
+    compare<64>(64, repeats);
+    compare<128>(128, repeats);
+    compare<256>(200, repeats);
+    compare<256>(256, repeats);
+    return 0;
+}
@@ -0,0 +1,56 @@
+//Сравнение решателей кратчайших путей из weighted_graph.h на одних и тех же случайных графах.
+//Сборка: g++ -O2 -std=c++17 -pthread sssp.cpp -o sssp
+//Запуск: ./sssp [кол-во вершин] [кол-во рёбер] [потоки]
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include "../Graph/weighted_graph.h"
+
+CSRGraph<> randomGraph(size_t verticesCount, size_t edgesCount, Weight maxWeight, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<uint32_t> vertex(0, verticesCount - 1);
+    std::uniform_int_distribution<Weight> weight(0, maxWeight);
+    CSRGraph<> graph(verticesCount);
+    for(size_t i = 0; i < edgesCount; ++i) {
+        graph.AddEdge(vertex(gen), vertex(gen), weight(gen));
+    }
+    graph.Build();
+    return graph;
+}
+
+template <typename Solver>
+std::vector<Distance> measure(const std::string& name, Solver solver) {
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<Distance> dist = solver();
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "  " << name << ": "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << " ms\n";
+    return dist;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    size_t m = argc > 2 ? std::stoul(argv[2]) : 8000000;
+    size_t threads = argc > 3 ? std::stoul(argv[3]) : std::thread::hardware_concurrency();
+
+    std::cout << "0-1 weights, V = " << n << ", E = " << m << "\n";
+    CSRGraph<> binary = randomGraph(n, m, 1, 1);
+    auto a = measure("0-1 BFS", [&] { return zeroOneBfs(&binary, 0); });
+    auto b = measure("radix heap Dijkstra", [&] { return dijkstraRadixHeap(&binary, 0); });
+    auto c = measure("delta-stepping", [&] { return deltaStepping(&binary, 0, 1, threads); });
+    if(a != b || a != c) {
+        std::cout << "MISMATCH\n";
+        return 1;
+    }
+
+    std::cout << "weights 0..1000, V = " << n << ", E = " << m << "\n";
+    CSRGraph<> weighted = randomGraph(n, m, 1000, 2);
+    auto d = measure("radix heap Dijkstra", [&] { return dijkstraRadixHeap(&weighted, 0); });
+    auto e = measure("delta-stepping", [&] { return deltaStepping(&weighted, 0, 100, threads); });
+    if(d != e) {
+        std::cout << "MISMATCH\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+//Сравнение 32- и 64-битных номеров вершин на одном и том же случайном графе:
+//сколько памяти занимают рёбра и сколько времени уходит на проходы, упирающиеся в чтение памяти.
+//Сборка: g++ -O2 -std=c++17 -pthread vertex_id.cpp -o vertex_id
+//Запуск: ./vertex_id [кол-во вершин] [кол-во рёбер]
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include "../Graph/weighted_graph.h"
+#include "../Graph/scc.h"
+
+template <typename F>
+long long milliseconds(F f) {
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+}
+
+template <typename Vertex>
+void run(size_t n, size_t m) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<uint64_t> vertex(0, n - 1);
+    std::uniform_int_distribution<Weight> weight(0, 1000);
+    CSRGraph<Vertex> weighted(n);
+    ListGraph<Vertex> unweighted(n);
+    for(size_t i = 0; i < m; ++i) {
+        Vertex from = vertex(gen), to = vertex(gen);
+        weighted.AddEdge(from, to, weight(gen));
+        unweighted.AddEdge(from, to);
+    }
+    weighted.Build();
+    CompactAdjacency<Vertex> adjacency(&unweighted, false);
+
+    std::cout << sizeof(Vertex) * 8 << "-bit vertices\n";
+    std::cout << "  CSR edges: " << weighted.EdgesCount() * sizeof(WeightedEdge<Vertex>) / (1 << 20) << " MiB\n";
+    std::cout << "  adjacency targets: " << adjacency.targets.size() * sizeof(Vertex) / (1 << 20) << " MiB\n";
+
+    Vertex checksum = 0;
+    long long scan = milliseconds([&] {
+        for(int repeat = 0; repeat < 10; ++repeat) {
+            for(auto to : adjacency.targets) {
+                checksum += to;
+            }
+        }
+    });
+    std::cout << "  10 scans of adjacency: " << scan << " ms (checksum " << checksum << ")\n";
+    std::cout << "  radix heap Dijkstra: " << milliseconds([&] { dijkstraRadixHeap(&weighted, 0); }) << " ms\n";
+    std::cout << "  Tarjan SCC: " << milliseconds([&] { stronglyConnectedComponents(&unweighted); }) << " ms\n";
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    size_t m = argc > 2 ? std::stoul(argv[2]) : 8000000;
+    std::cout << "V = " << n << ", E = " << m << "\n";
+    run<uint32_t>(n, m);
+    run<uint64_t>(n, m);
+    return 0;
+}
@@ -0,0 +1,109 @@
+#ifndef DSF_BETWEENNESS_H
+#define DSF_BETWEENNESS_H
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <atomic>
+#include <thread>
+#include "graph.h"
+
+//Алгоритм Брандеса по заданному списку источников. Для каждого источника s:
+//прямой проход - ShortestPathCounter (расстояния и кол-во кратчайших путей sigma),
+//обратный проход - по вершинам в порядке убывания расстояния копим зависимость
+//delta[v] = сумма по w, где v -> w ребро кратчайших путей, sigma[v] / sigma[w] * (1 + delta[w]).
+//Источники разбирают потоки, у каждого потока свои рабочие массивы и свой вектор-накопитель,
+//в конце накопители складываются, так что синхронизации внутри прохода нет
+template <typename Vertex>
+std::vector<double> brandes(const CompactAdjacency<Vertex>& adjacency, const std::vector<Vertex>& sources,
+                            size_t threadsCount) {
+    size_t n = adjacency.offsets.size() - 1;
+    threadsCount = std::max<size_t>(1, std::min(threadsCount, sources.size()));
+    std::vector<std::vector<double>> accumulators(threadsCount);
+    std::atomic<size_t> nextSource(0);
+
+    auto work = [&](size_t t) {
+        std::vector<double>& centrality = accumulators[t];
+        centrality.assign(n, 0.0);
+        ShortestPathCounter<Vertex, double> counter(adjacency);
+        std::vector<double> delta(n, 0.0);
+        for(size_t k = nextSource.fetch_add(1); k < sources.size(); k = nextSource.fetch_add(1)) {
+            Vertex source = sources[k];
+            counter.Run(source);
+            const std::vector<Vertex>& order = counter.Order();
+            for(size_t i = order.size(); i-- > 0;) {
+                Vertex v = order[i];
+                double dependency = 0.0;
+                for(size_t e = adjacency.Begin(v); e < adjacency.End(v); ++e) {
+                    Vertex w = adjacency.targets[e];
+                    if(counter.Dist(w) == counter.Dist(v) + 1) {
+                        dependency += counter.Paths(v) / counter.Paths(w) * (1.0 + delta[w]);
+                    }
+                }
+                delta[v] = dependency;
+                if(v != source) {
+                    centrality[v] += dependency;
+                }
+            }
+            for(auto v : order) {
+                delta[v] = 0.0;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for(size_t t = 1; t < threadsCount; ++t) {
+        threads.emplace_back(work, t);
+    }
+    work(0);
+    for(auto& th : threads) {
+        th.join();
+    }
+    for(size_t t = 1; t < threadsCount; ++t) {
+        for(size_t v = 0; v < n; ++v) {
+            accumulators[0][v] += accumulators[t][v];
+        }
+    }
+    return std::move(accumulators[0]);
+}
+
+//Точная betweenness centrality всех вершин, O(V * E).
+//Пары считаются упорядоченными, поэтому для неорграфа (ListGraph) значения вдвое больше неориентированного определения
+template <typename Vertex>
+std::vector<double> betweennessCentrality(const IGraph<Vertex>* const graph,
+                                          size_t threadsCount = std::thread::hardware_concurrency()) {
+    CompactAdjacency<Vertex> adjacency(graph, false);
+    std::vector<Vertex> sources(graph->VerticesCount());
+    std::iota(sources.begin(), sources.end(), Vertex(0));
+    return brandes(adjacency, sources, threadsCount);
+}
+
+//Приближённая betweenness centrality по samples случайным источникам (без повторов).
+//Сумма по выборке умножается на V / samples, это несмещённая оценка точного значения.
+//Нужна для графов, где V полных обходов не уложить ни в какое время
+template <typename Vertex>
+std::vector<double> approximateBetweennessCentrality(const IGraph<Vertex>* const graph, size_t samples,
+                                                     uint32_t seed = 0,
+                                                     size_t threadsCount = std::thread::hardware_concurrency()) {
+    size_t n = graph->VerticesCount();
+    samples = std::min(samples, n);
+    if(samples == 0) {
+        return std::vector<double>(n, 0.0);
+    }
+    CompactAdjacency<Vertex> adjacency(graph, false);
+    std::vector<Vertex> sources(n);
+    std::iota(sources.begin(), sources.end(), Vertex(0));
+    //частичная перетасовка Фишера-Йетса: первые samples элементов - случайная выборка
+    std::mt19937 gen(seed);
+    for(size_t i = 0; i < samples; ++i) {
+        std::uniform_int_distribution<size_t> pick(i, n - 1);
+        std::swap(sources[i], sources[pick(gen)]);
+    }
+    sources.resize(samples);
+    std::vector<double> centrality = brandes(adjacency, sources, threadsCount);
+    double scale = static_cast<double>(n) / samples;
+    for(auto& c : centrality) {
+        c *= scale;
+    }
+    return centrality;
+}
+#endif //DSF_BETWEENNESS_H
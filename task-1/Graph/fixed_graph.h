@@ -0,0 +1,206 @@
+#ifndef DSF_FIXED_GRAPH_H
+#define DSF_FIXED_GRAPH_H
+#include <array>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+#include "vertex.h"
+
+//Битовое множество на N элементов из (N + 63) / 64 машинных слов.
+//В отличие от std::bitset все операции constexpr уже в C++17
+template <size_t N>
+class FixedBitset {
+public:
+    static constexpr size_t WORDS = (N + 63) / 64;
+
+    constexpr void Set(size_t i) {
+        words[i / 64] |= uint64_t(1) << (i % 64);
+    }
+
+    constexpr void Reset(size_t i) {
+        words[i / 64] &= ~(uint64_t(1) << (i % 64));
+    }
+
+    constexpr bool Test(size_t i) const {
+        return (words[i / 64] >> (i % 64)) & 1;
+    }
+
+    constexpr bool Any() const {
+        for(size_t w = 0; w < WORDS; ++w) {
+            if(words[w] != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr bool Intersects(const FixedBitset& other) const {
+        for(size_t w = 0; w < WORDS; ++w) {
+            if((words[w] & other.words[w]) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //Наименьший общий элемент с other, N если пересечение пусто
+    constexpr size_t FirstCommon(const FixedBitset& other) const {
+        for(size_t w = 0; w < WORDS; ++w) {
+            uint64_t word = words[w] & other.words[w];
+            if(word != 0) {
+                return w * 64 + __builtin_ctzll(word);
+            }
+        }
+        return N;
+    }
+
+    constexpr FixedBitset& operator|=(const FixedBitset& other) {
+        for(size_t w = 0; w < WORDS; ++w) {
+            words[w] |= other.words[w];
+        }
+        return *this;
+    }
+
+    //Убрать из множества все элементы other
+    constexpr FixedBitset& Subtract(const FixedBitset& other) {
+        for(size_t w = 0; w < WORDS; ++w) {
+            words[w] &= ~other.words[w];
+        }
+        return *this;
+    }
+
+    //Вызвать f(i) для каждого элемента множества по возрастанию
+    template <typename F>
+    constexpr void ForEach(F f) const {
+        for(size_t w = 0; w < WORDS; ++w) {
+            uint64_t word = words[w];
+            while(word != 0) {
+                f(w * 64 + __builtin_ctzll(word));
+                word &= word - 1;   //снять младший единичный бит
+            }
+        }
+    }
+private:
+    std::array<uint64_t, WORDS> words{};
+};
+
+//Ориентированный граф не более чем на N вершин, матрица смежности из N битовых строк.
+//Вся память лежит внутри объекта (без кучи), посещённые вершины и фронт обхода - FixedBitset<N>,
+//то есть при N <= 64 это одно машинное слово. Все алгоритмы constexpr и могут считаться при компиляции
+template <size_t N, typename Vertex = uint32_t>
+class FixedGraph {
+public:
+    static_assert(N > 0, "FixedGraph capacity must be positive");
+    static_assert(N <= static_cast<size_t>(VertexTraits<Vertex>::NO_VERTEX), "FixedGraph capacity does not fit into Vertex");
+
+    //расстояние до недостижимой вершины в Bfs
+    static constexpr Vertex NO_PATH = VertexTraits<Vertex>::NO_VERTEX;
+
+    constexpr FixedGraph(size_t verticesCount) : verticesCount(verticesCount), rows{} {
+        if(verticesCount > N) {
+            throw std::length_error("FixedGraph: too many vertices for this capacity");
+        }
+    }
+
+    constexpr void AddEdge(Vertex from, Vertex to) {
+        if(from >= verticesCount || to >= verticesCount) {
+            throw std::out_of_range("FixedGraph::AddEdge: vertex out of range");
+        }
+        rows[from].Set(to);
+    }
+
+    constexpr size_t VerticesCount() const {
+        return verticesCount;
+    }
+
+    constexpr const FixedBitset<N>& Row(Vertex vertex) const {
+        return rows[vertex];
+    }
+
+    //Расстояния от start до всех вершин, обход по уровням: следующий фронт - OR строк текущего фронта без посещённых
+    constexpr std::array<Vertex, N> Bfs(Vertex start) const {
+        std::array<Vertex, N> dist{};
+        for(size_t v = 0; v < N; ++v) {
+            dist[v] = NO_PATH;
+        }
+        FixedBitset<N> visited, frontier;
+        frontier.Set(start);
+        for(Vertex level = 0; frontier.Any(); ++level) {
+            visited |= frontier;
+            FixedBitset<N> next;
+            frontier.ForEach([&](size_t v) {
+                dist[v] = level;
+                next |= rows[v];
+            });
+            frontier = next.Subtract(visited);
+        }
+        return dist;
+    }
+
+    //Есть ли ориентированный цикл. Итеративный DFS, где белые и серые вершины - битовые множества:
+    //следующий ребёнок - первый общий бит строки и белых, цикл - общий бит строки и серых.
+    //Серые предки вершины остаются серыми, пока она в стеке, поэтому серых проверяем один раз при входе.
+    //Каждая вершина входит в стек и выходит из него по разу, итого O(V * N / 64)
+    constexpr bool HasCycle() const {
+        FixedBitset<N> white, gray;
+        for(size_t v = 0; v < verticesCount; ++v) {
+            white.Set(v);
+        }
+        std::array<Vertex, N> stack{};
+        size_t size = 0;
+        for(size_t root = white.FirstCommon(white); root < N; root = white.FirstCommon(white)) {
+            white.Reset(root);
+            gray.Set(root);
+            if(rows[root].Intersects(gray)) {
+                return true;
+            }
+            stack[size++] = static_cast<Vertex>(root);
+            while(size > 0) {
+                Vertex v = stack[size - 1];
+                size_t next = rows[v].FirstCommon(white);
+                if(next == N) {
+                    gray.Reset(v);  //все потомки обработаны - вершина чёрная
+                    --size;
+                    continue;
+                }
+                white.Reset(next);
+                gray.Set(next);
+                if(rows[next].Intersects(gray)) {
+                    return true;
+                }
+                stack[size++] = static_cast<Vertex>(next);
+            }
+        }
+        return false;
+    }
+
+    //Двудольна ли часть графа, достижимая из start (как и isBipartite из graph.h).
+    //Доли - чётные и нечётные уровни обхода, граф не двудолен если есть ребро внутри одной доли
+    constexpr bool IsBipartite(Vertex start = 0) const {
+        FixedBitset<N> visited, frontier, parts[2];
+        frontier.Set(start);
+        for(size_t level = 0; frontier.Any(); ++level) {
+            visited |= frontier;
+            parts[level % 2] |= frontier;
+            FixedBitset<N> next;
+            frontier.ForEach([&](size_t v) {
+                next |= rows[v];
+            });
+            frontier = next.Subtract(visited);
+        }
+        for(size_t p = 0; p < 2; ++p) {
+            bool conflict = false;
+            parts[p].ForEach([&](size_t v) {
+                conflict = conflict || rows[v].Intersects(parts[p]);
+            });
+            if(conflict) {
+                return false;
+            }
+        }
+        return true;
+    }
+private:
+    size_t verticesCount;
+    std::array<FixedBitset<N>, N> rows;
+};
+#endif //DSF_FIXED_GRAPH_H
@@ -4,6 +4,13 @@
 #include <algorithm>
 #include <queue>
 #include <iostream>
+#include <string>
+#include <array>
+#include <type_traits>
+#include <memory>
+#include <cstdint>
+#include "vertex.h"
+#include "fixed_graph.h"
 
 enum Color {
     WHITE,
@@ -11,26 +18,30 @@ enum Color {
     BLACK
 };
 
+template <typename Vertex = uint32_t>
 class IGraph {  //Интерфейс графа
 public:
+    using VertexType = Vertex;
+
     virtual ~IGraph() {}    //Виртуальный деструктор чтобы при удалении по указателю не было утечки памяти
 
     //Добавить ребро выходящее из вершины from и ведущее в вершину to
-    virtual void AddEdge(size_t from, size_t to) = 0;   //чисто виртуальная функция (не имеет реализации в этом классе
+    virtual void AddEdge(Vertex from, Vertex to) = 0;   //чисто виртуальная функция (не имеет реализации в этом классе
 
     //получить кол-во вершин в графе
     virtual size_t VerticesCount() const  = 0;
 
     //Получить вектор всех вершин в которые можно попасть по ребру из вершины vertex
-    virtual std::vector<size_t> GetVertices(size_t vertex) const = 0;
+    virtual std::vector<Vertex> GetVertices(Vertex vertex) const = 0;
 };
 
 //невзвешенный неорграф
-class ListGraph : public IGraph {
+template <typename Vertex = uint32_t>
+class ListGraph : public IGraph<Vertex> {
 public:
-    ListGraph(size_t verticesNumber) : vertices(verticesNumber){}
+    ListGraph(size_t verticesNumber) : vertices(VertexTraits<Vertex>::CheckVerticesCount(verticesNumber)){}
 
-    void AddEdge(size_t from, size_t to) override {
+    void AddEdge(Vertex from, Vertex to) override {
         vertices.at(from).push_back(to);
         vertices.at(to).push_back(from);
     }
@@ -39,21 +50,22 @@ public:
         return vertices.size();
     }
 
-    std::vector<size_t> GetVertices(size_t vertex) const override {
+    std::vector<Vertex> GetVertices(Vertex vertex) const override {
         return vertices.at(vertex);
     }
 private:
-    std::vector<std::vector<size_t>> vertices;
+    std::vector<std::vector<Vertex>> vertices;
 };
 
 //Ориентированный граф на основе матрицы инцендентности, реализующий интерфейс IGraph
-class MatrixGraph : public IGraph {
+template <typename Vertex = uint32_t>
+class MatrixGraph : public IGraph<Vertex> {
 public:
     //Конструктор принимает кол-во вершин в графе
-    MatrixGraph(size_t verticesCount) : vertices(verticesCount, std::vector<bool>(verticesCount, false)) { //задаём матрицу verticesCount x verticesCount заполненую false
+    MatrixGraph(size_t verticesCount) : vertices(VertexTraits<Vertex>::CheckVerticesCount(verticesCount), std::vector<bool>(verticesCount, false)) { //задаём матрицу verticesCount x verticesCount заполненую false
     }
 
-    void AddEdge(size_t from, size_t to) override {
+    void AddEdge(Vertex from, Vertex to) override {
         vertices.at(from).at(to) = true;
         //Если бы граф был неориентированным то также было бы vertices.at(to).at(from) = true;
     }
@@ -63,9 +75,9 @@ public:
     }
 
     //Внимание! эта функция работает за линейное от кол-ва вершин время
-    std::vector<size_t> GetVertices(size_t vertex) const override {
-        std::vector<size_t> result;
-        for(size_t i = 0, n = vertices.size(); i < n; ++i) {
+    std::vector<Vertex> GetVertices(Vertex vertex) const override {
+        std::vector<Vertex> result;
+        for(Vertex i = 0, n = static_cast<Vertex>(vertices.size()); i < n; ++i) {
             if(vertices.at(vertex)[i]) {    //если в нашей матрице на позиции (vertex, i) стоит true то из vertex по ребру можно попасть в i
                 result.push_back(i);        //добавляем i в результат. Амартизированное время работы будет константным
             }
@@ -76,8 +88,145 @@ private:
     std::vector<std::vector<bool>> vertices;   //Матрицу будем хранить в виде вектора векторов, кол-во столбцов равео кол-ву строк  равно  кол-ву вершин
 };
 
+//Список смежности IGraph, один раз скопированный в два плоских массива.
+//Нужен чтобы не вызывать виртуальный GetVertices (и не создавать вектор) при каждом проходе по вершине
+template <typename Vertex = uint32_t>
+struct CompactAdjacency {
+    std::vector<size_t> offsets;    //рёбра вершины v - targets[offsets[v]] .. targets[offsets[v + 1] - 1]
+    std::vector<Vertex> targets;
+
+    //reversed = true - построить граф с развёрнутыми рёбрами
+    CompactAdjacency(const IGraph<Vertex>* const graph, bool reversed) : offsets(graph->VerticesCount() + 1, 0) {
+        size_t n = graph->VerticesCount();
+        std::vector<std::vector<Vertex>> lists(n);
+        for(Vertex from = 0; from < n; ++from) {
+            lists[from] = graph->GetVertices(from);
+            if(reversed) {
+                for(auto to : lists[from]) {
+                    ++offsets[to + 1];
+                }
+            } else {
+                offsets[from + 1] = lists[from].size();
+            }
+        }
+        for(size_t v = 0; v < n; ++v) {
+            offsets[v + 1] += offsets[v];
+        }
+        targets.resize(offsets[n]);
+        std::vector<size_t> position(offsets.begin(), offsets.end() - 1);
+        for(Vertex from = 0; from < n; ++from) {
+            for(auto to : lists[from]) {
+                if(reversed) {
+                    targets[position[to]++] = from;
+                } else {
+                    targets[position[from]++] = to;
+                }
+            }
+        }
+    }
+
+    size_t Begin(Vertex vertex) const { return offsets[vertex]; }
+    size_t End(Vertex vertex) const { return offsets[vertex + 1]; }
+
+    size_t VerticesCount() const { return offsets.size() - 1; }
+
+    //Вызвать f(to) для каждого ребра vertex -> to
+    template <typename F>
+    void ForEachNeighbour(Vertex vertex, F f) const {
+        for(size_t i = offsets[vertex]; i < offsets[vertex + 1]; ++i) {
+            f(targets[i]);
+        }
+    }
+};
+
+//Тот же интерфейс, что у CompactAdjacency, но соседи читаются прямо из IGraph::GetVertices без копии графа.
+//Подходит для одного обхода, который может остановиться задолго до того, как увидит весь граф
+template <typename Vertex = uint32_t>
+struct GraphAdjacency {
+    const IGraph<Vertex>* graph;
+
+    GraphAdjacency(const IGraph<Vertex>* const graph) : graph(graph) {}
+
+    size_t VerticesCount() const { return graph->VerticesCount(); }
+
+    template <typename F>
+    void ForEachNeighbour(Vertex vertex, F f) const {
+        for(auto to : graph->GetVertices(vertex)) {
+            f(to);
+        }
+    }
+};
+
+//Копия графа в FixedGraph<N>, вершин в графе должно быть не больше N
+template <size_t N, typename Vertex>
+FixedGraph<N, Vertex> toFixedGraph(const IGraph<Vertex>* const graph) {
+    FixedGraph<N, Vertex> result(graph->VerticesCount());
+    for(Vertex from = 0; from < graph->VerticesCount(); ++from) {
+        for(auto to : graph->GetVertices(from)) {
+            result.AddEdge(from, to);
+        }
+    }
+    return result;
+}
+
+//Копия в FixedGraph<N> только тех строк, что достижимы из start, остальные строки пустые
+template <size_t N, typename Vertex>
+FixedGraph<N, Vertex> toFixedGraphFrom(const IGraph<Vertex>* const graph, Vertex start) {
+    FixedGraph<N, Vertex> result(graph->VerticesCount());
+    FixedBitset<N> seen;
+    std::array<Vertex, N> q{};
+    size_t head = 0, tail = 0;
+    q[tail++] = start;
+    seen.Set(start);
+    while(head < tail) {
+        Vertex from = q[head++];
+        for(auto to : graph->GetVertices(from)) {
+            result.AddEdge(from, to);
+            if(!seen.Test(to)) {
+                seen.Set(to);
+                q[tail++] = to;
+            }
+        }
+    }
+    return result;
+}
+
+//Граф, заданный через IGraph, приходится копировать в FixedGraph виртуальными GetVertices, поэтому битовое ядро
+//выгодно только пока граф не больше maxVertices - порога, измеренного в Bench/small_graph.cpp.
+//Если граф подходит - записывает в result ответ kernel(копия графа) и возвращает true, иначе возвращает false.
+//copy(graph, tag) строит копию нужной ёмкости, tag - std::integral_constant с этой ёмкостью
+template <typename Vertex, typename Copy, typename Kernel>
+bool runOnFixedGraph(const IGraph<Vertex>* const graph, size_t maxVertices, Copy copy, Kernel kernel, bool& result) {
+    size_t n = graph->VerticesCount();
+    if(n > maxVertices) {
+        return false;
+    }
+    //ёмкости, которые не помещаются в Vertex (например 256 для uint8_t), даже не инстанцируются
+    const size_t maxCapacity = VertexTraits<Vertex>::NO_VERTEX;
+    if constexpr(64 <= maxCapacity) {
+        if(n <= 64) {
+            result = kernel(copy(std::integral_constant<size_t, 64>()));
+            return true;
+        }
+    }
+    if constexpr(128 <= maxCapacity) {
+        if(n <= 128) {
+            result = kernel(copy(std::integral_constant<size_t, 128>()));
+            return true;
+        }
+    }
+    if constexpr(256 <= maxCapacity) {
+        if(n <= 256) {
+            result = kernel(copy(std::integral_constant<size_t, 256>()));
+            return true;
+        }
+    }
+    return false;
+}
+
 // Функция принимает указатель на интерфкйс графа, вершину, и ссылку на вектор цветов
-bool dfs(const IGraph* const graph, size_t vertex, std::vector<Color>& colors) {
+template <typename Vertex>
+bool dfs(const IGraph<Vertex>* const graph, VertexArg<Vertex> vertex, std::vector<Color>& colors) {
     colors[vertex] = GRAY;  //когда зашли в вершину закрасили её в серый цвет
     for(auto nextVertex : graph->GetVertices(vertex)) { //Перебираем все вершины в которые можно попасть по ребру из данной
         if(colors[nextVertex] == GRAY) {
@@ -91,12 +240,14 @@ bool dfs(const IGraph* const graph, size_t vertex, std::vector<Color>& colors) {
     return false;
 }
 
-bool hasCycle(const IGraph* const graph) {
+//hasCycle обычным рекурсивным dfs, без переключения на FixedGraph
+template <typename Vertex>
+bool hasCycleDfs(const IGraph<Vertex>* const graph) {
     auto verticesColors = std::vector<Color>(graph->VerticesCount(), WHITE);    //Задаём вектор цветов, индекс - номер вершины
     //Ищим первую белую вершину, здесь тоже намеренное усложнение чтобы показать работу с find, быстрее было просто один раз пройти for
     auto it = std::find(verticesColors.begin(), verticesColors.end(), WHITE);
     while (it != verticesColors.end()) {    //В случае если белых вершин нет, find вернёт vertices.end()
-        if(dfs(graph, it - verticesColors.begin(), verticesColors)) {   //запускаем dfs для белой вершины, индекс находим как разницу найденого итератора и begin
+        if(dfs(graph, static_cast<Vertex>(it - verticesColors.begin()), verticesColors)) {   //запускаем dfs для белой вершины, индекс находим как разницу найденого итератора и begin
             return true;    //Нашли цикл дальше можно не идти
         }
         it = std::find(verticesColors.begin(), verticesColors.end(), WHITE);    //Ищем есть ли ещё белые вершины, если граф не очень связан
@@ -104,25 +255,43 @@ bool hasCycle(const IGraph* const graph) {
     return false;
 }
 
+//Порог переключения hasCycle на FixedGraph::HasCycle, см. Bench/small_graph.cpp.
+//Копирование через GetVertices стоит столько же, сколько сам dfs, и выигрыша нет ни при каком n
+//(на 8..256 вершинах разница в пределах шума), поэтому для IGraph переключение выключено.
+//Ядро полезно, когда граф сразу строится как FixedGraph
+const size_t HAS_CYCLE_FIXED_MAX_VERTICES = 0;
+
+template <typename Vertex>
+bool hasCycle(const IGraph<Vertex>* const graph) {
+    bool fixedResult = false;
+    if(runOnFixedGraph(graph, HAS_CYCLE_FIXED_MAX_VERTICES,
+                       [&](auto capacity) { return toFixedGraph<decltype(capacity)::value>(graph); },
+                       [](const auto& fixed) { return fixed.HasCycle(); }, fixedResult)) {
+        return fixedResult;
+    }
+    return hasCycleDfs(graph);
+}
+
 
-int bfs(const IGraph* const graph, size_t vertex) {
-    std::queue<size_t> q;
+template <typename Vertex>
+int bfs(const IGraph<Vertex>* const graph, VertexArg<Vertex> vertex) {
+    std::queue<Vertex> q;
     q.push (vertex);
     std::vector<bool> used (graph->VerticesCount(), false);
-    std::vector<int> length(graph->VerticesCount()), parent(graph->VerticesCount());
+    std::vector<Vertex> length(graph->VerticesCount()), parent(graph->VerticesCount());
     used[vertex] = true;
-    parent[vertex] = -1;
+    parent[vertex] = VertexTraits<Vertex>::NO_VERTEX;
     while (!q.empty()) {
-        size_t nextVertex = q.front();
+        Vertex nextVertex = q.front();
         q.pop();
         for (size_t i=0; i<graph->GetVertices(nextVertex).size(); ++i) {
-            size_t to = graph->GetVertices(nextVertex)[i];
+            Vertex to = graph->GetVertices(nextVertex)[i];
 
             if (!used[to]) {
             used[to] = true;
             q.push (to);
             length[to] = length[nextVertex] + 1;
-            parent[to] = static_cast<int>(nextVertex);
+            parent[to] = nextVertex;
             }
             else {
             }
@@ -131,14 +300,15 @@ int bfs(const IGraph* const graph, size_t vertex) {
     return 0;
 }
 
-void minCycleConteiningVertex(const IGraph* const graph, size_t vertex, int& cicle_len) {
-    std::queue<size_t> q;
+template <typename Vertex>
+void minCycleConteiningVertex(const IGraph<Vertex>* const graph, VertexArg<Vertex> vertex, int& cicle_len) {
+    std::queue<Vertex> q;
     q.push (vertex);
     std::vector<bool> used (graph->VerticesCount(), false);
     std::vector<int> length(graph->VerticesCount());
     used[vertex] = true;
     while (!q.empty()) {
-        size_t from = q.front();
+        Vertex from = q.front();
         q.pop();
         for (auto to : graph->GetVertices(from)) {
             if (!used[to]) {
@@ -159,41 +329,86 @@ void minCycleConteiningVertex(const IGraph* const graph, size_t vertex, int& cic
     }
 }
 
-int minCycle(const IGraph* const graph) {
+template <typename Vertex>
+int minCycle(const IGraph<Vertex>* const graph) {
     int minCycle = -1;
-    for(size_t i = 0; i < graph->VerticesCount(); i++)
+    for(Vertex i = 0; i < graph->VerticesCount(); i++)
         minCycleConteiningVertex(graph, i, minCycle);
 
     return minCycle;
 }
 
-size_t kShortestPaths(const IGraph* const graph, size_t start, size_t finish){
-    std::vector<size_t> shortest_paths(graph->VerticesCount());
-    std::vector<bool> next_ring(graph->VerticesCount());
-    std::queue<size_t> q;
-    q.push (start);
-    shortest_paths[start] = 1;
-    while (!q.empty()) {
-        size_t curVertex = q.front();
-        q.pop();
-        if(next_ring[curVertex] == true){
-            if(shortest_paths[finish] != 0){
-                return shortest_paths[finish];
-            }
-            next_ring.assign(next_ring.size(), false);
-        }
-        for (size_t nextVertex : graph->GetVertices(curVertex)) {
+//BFS от одной вершины, который кроме расстояний считает кол-во кратчайших путей до каждой вершины.
+//Общий слой для kShortestPaths и betweenness centrality: рабочие массивы выделяются один раз,
+//а перед каждым Run сбрасываются только вершины, посещённые прошлым запуском.
+//Count - тип счётчика путей: size_t для точного ответа, double если путей может быть больше 2^64.
+//Adjacency - откуда брать соседей: CompactAdjacency для многих запусков, GraphAdjacency для одного
+template <typename Vertex, typename Count = size_t, typename Adjacency = CompactAdjacency<Vertex>>
+class ShortestPathCounter {
+public:
+    ShortestPathCounter(const Adjacency& adjacency)
+        : adjacency(adjacency), dist(adjacency.VerticesCount(), VertexTraits<Vertex>::NO_VERTEX),
+          paths(new Count[adjacency.VerticesCount()]) {}
 
-            if (shortest_paths[nextVertex] == 0) {
-                shortest_paths[nextVertex] = shortest_paths[curVertex];
-                q.push(nextVertex);
-                next_ring[nextVertex] = true;
-            }
-            else if(next_ring[nextVertex]) {
-                shortest_paths[nextVertex] += shortest_paths[curVertex];
+    //Посчитать пути из start. Если задан stop, обход прекращается как только пути до stop посчитаны
+    void Run(Vertex start, Vertex stop = VertexTraits<Vertex>::NO_VERTEX) {
+        for(auto v : order) {
+            dist[v] = VertexTraits<Vertex>::NO_VERTEX;
+        }
+        order.clear();
+        dist[start] = 0;
+        paths[start] = 1;
+        order.push_back(start);
+        //order одновременно очередь BFS: вершины лежат в нём по неубыванию расстояния
+        for(size_t head = 0; head < order.size(); ++head) {
+            Vertex from = order[head];
+            if(stop != VertexTraits<Vertex>::NO_VERTEX && dist[stop] <= dist[from]) {
+                break;  //весь предыдущий уровень обработан, paths[stop] больше не изменится
             }
+            adjacency.ForEachNeighbour(from, [&](Vertex to) {
+                if(dist[to] == VertexTraits<Vertex>::NO_VERTEX) {
+                    dist[to] = dist[from] + 1;
+                    paths[to] = 0;
+                    order.push_back(to);
+                }
+                if(dist[to] == dist[from] + 1) {
+                    paths[to] += paths[from];
+                }
+            });
         }
     }
+
+    //Посещённые вершины в порядке обхода (по неубыванию расстояния)
+    const std::vector<Vertex>& Order() const {
+        return order;
+    }
+
+    //Расстояние от start, NO_VERTEX если вершина не достигнута
+    Vertex Dist(Vertex vertex) const {
+        return dist[vertex];
+    }
+
+    //Кол-во кратчайших путей от start
+    Count Paths(Vertex vertex) const {
+        return dist[vertex] == VertexTraits<Vertex>::NO_VERTEX ? Count(0) : paths[vertex];
+    }
+private:
+    const Adjacency& adjacency;
+    std::vector<Vertex> dist;
+    //paths[v] имеет смысл только при dist[v] != NO_VERTEX и пишется при открытии вершины,
+    //поэтому массив не заполняется нулями - для одного запроса это второй проход по O(V) памяти
+    std::unique_ptr<Count[]> paths;
+    std::vector<Vertex> order;
+};
+
+//Кол-во кратчайших путей из start в finish, 0 если finish недостижима.
+//Граф не копируется: обход читает GetVertices и останавливается на уровне finish
+template <typename Vertex>
+size_t kShortestPaths(const IGraph<Vertex>* const graph, VertexArg<Vertex> start, VertexArg<Vertex> finish){
+    GraphAdjacency<Vertex> adjacency(graph);
+    ShortestPathCounter<Vertex, size_t, GraphAdjacency<Vertex>> counter(adjacency);
+    counter.Run(start, finish);
+    return counter.Paths(finish);
 }
 
 enum Type {
@@ -207,18 +422,20 @@ Type t_rev(Type a){
     if(a == SECOND) return FIRST;
 }
 
-std::string isBipartite(const IGraph* const graph) {
-    std::queue<size_t> q;
+//isBipartite обычным bfs, без переключения на FixedGraph
+template <typename Vertex>
+std::string isBipartiteBfs(const IGraph<Vertex>* const graph) {
+    std::queue<Vertex> q;
     std::vector<bool> used (graph->VerticesCount(), false);
     std::vector<Type> Part(graph->VerticesCount(), NONE);
-    size_t vertex = 0;
+    Vertex vertex = 0;
     q.push(vertex);
     used[vertex] = true;
     Part[vertex] = FIRST;
     while (!q.empty()) {
-        size_t curVertex = q.front();
+        Vertex curVertex = q.front();
         q.pop();
-        for (size_t nextVertex : graph->GetVertices(curVertex)) {
+        for (Vertex nextVertex : graph->GetVertices(curVertex)) {
             if (!used[nextVertex]) {
                 if(Part[nextVertex] == NONE)
                     Part[nextVertex] = t_rev(Part[curVertex]);
@@ -238,4 +455,19 @@ std::string isBipartite(const IGraph* const graph) {
     }
     return "YES";
 }
+
+//Порог переключения isBipartite на FixedGraph::IsBipartite, см. Bench/small_graph.cpp:
+//до 16 вершин ядро стабильно быстрее на 5-15%, с 32 вершин уже медленнее обычного bfs
+const size_t IS_BIPARTITE_FIXED_MAX_VERTICES = 16;
+
+template <typename Vertex>
+std::string isBipartite(const IGraph<Vertex>* const graph) {
+    bool fixedResult = false;
+    if(runOnFixedGraph(graph, IS_BIPARTITE_FIXED_MAX_VERTICES,
+                       [&](auto capacity) { return toFixedGraphFrom<decltype(capacity)::value>(graph, Vertex(0)); },
+                       [](const auto& fixed) { return fixed.IsBipartite(0); }, fixedResult)) {
+        return fixedResult ? "YES" : "NO";
+    }
+    return isBipartiteBfs(graph);
+}
 #endif //DSF_GRAPH_H
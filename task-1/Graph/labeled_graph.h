@@ -0,0 +1,182 @@
+#ifndef DSF_LABELED_GRAPH_H
+#define DSF_LABELED_GRAPH_H
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+#include "vertex.h"
+
+//Метка ребра, например цвет в задаче про чередующиеся цвета
+using Label = uint32_t;
+
+template <typename Vertex = uint32_t>
+struct LabeledEdge {
+    Vertex to;
+    Label label;
+};
+
+//Ориентированный граф, у каждого ребра одна из labelsCount меток
+template <typename Vertex = uint32_t>
+class LabeledGraph {
+public:
+    LabeledGraph(size_t verticesCount, size_t labelsCount)
+        : vertices(VertexTraits<Vertex>::CheckVerticesCount(verticesCount)), labelsCount(labelsCount) {}
+
+    void AddEdge(Vertex from, Vertex to, Label label) {
+        if(label >= labelsCount || to >= vertices.size()) {
+            throw std::out_of_range("LabeledGraph::AddEdge: label or vertex out of range");
+        }
+        vertices.at(from).push_back({to, label});
+    }
+
+    size_t VerticesCount() const {
+        return vertices.size();
+    }
+
+    size_t LabelsCount() const {
+        return labelsCount;
+    }
+
+    const std::vector<LabeledEdge<Vertex>>& GetEdges(Vertex vertex) const {
+        return vertices.at(vertex);
+    }
+private:
+    std::vector<std::vector<LabeledEdge<Vertex>>> vertices;
+    size_t labelsCount;
+};
+
+//Недетерминированный автомат над метками рёбер, не больше 64 состояний.
+//Множество состояний - одно 64-битное слово, переход по метке из множества - OR масок переходов его состояний
+class LabelAutomaton {
+public:
+    static constexpr size_t MAX_STATES = 64;
+
+    LabelAutomaton(size_t statesCount, size_t labelsCount)
+        : statesCount(statesCount), labelsCount(labelsCount), transitions(statesCount * labelsCount, 0) {
+        if(statesCount > MAX_STATES) {
+            throw std::length_error("LabelAutomaton: at most 64 states are supported");
+        }
+    }
+
+    void AddTransition(size_t from, Label label, size_t to) {
+        if(from >= statesCount || to >= statesCount || label >= labelsCount) {
+            throw std::out_of_range("LabelAutomaton::AddTransition: state or label out of range");
+        }
+        transitions[from * labelsCount + label] |= uint64_t(1) << to;
+    }
+
+    void SetStart(size_t state) {
+        if(state >= statesCount) {
+            throw std::out_of_range("LabelAutomaton::SetStart: state out of range");
+        }
+        start |= uint64_t(1) << state;
+    }
+
+    void SetAccepting(size_t state) {
+        if(state >= statesCount) {
+            throw std::out_of_range("LabelAutomaton::SetAccepting: state out of range");
+        }
+        accepting |= uint64_t(1) << state;
+    }
+
+    uint64_t StartStates() const {
+        return start;
+    }
+
+    uint64_t AcceptingStates() const {
+        return accepting;
+    }
+
+    size_t LabelsCount() const {
+        return labelsCount;
+    }
+
+    //Множество состояний после чтения метки label из множества states
+    uint64_t Step(uint64_t states, Label label) const {
+        uint64_t result = 0;
+        while(states != 0) {
+            size_t state = __builtin_ctzll(states);
+            result |= transitions[state * labelsCount + label];
+            states &= states - 1;
+        }
+        return result;
+    }
+
+    //Соседние рёбра пути не могут иметь одинаковую метку - правило из
+    //Solution::shortestAlternatingPaths, обобщённое на labelsCount цветов.
+    //Состояние 0 - ещё не было рёбер, состояние i + 1 - последнее ребро имело метку i
+    static LabelAutomaton Alternating(size_t labelsCount) {
+        LabelAutomaton automaton(labelsCount + 1, labelsCount);
+        automaton.SetStart(0);
+        for(size_t state = 0; state <= labelsCount; ++state) {
+            automaton.SetAccepting(state);
+            for(Label label = 0; label < labelsCount; ++label) {
+                if(state != label + 1) {
+                    automaton.AddTransition(state, label, label + 1);
+                }
+            }
+        }
+        return automaton;
+    }
+private:
+    size_t statesCount;
+    size_t labelsCount;
+    std::vector<uint64_t> transitions;  //transitions[state * labelsCount + label] - маска следующих состояний
+    uint64_t start = 0;
+    uint64_t accepting = 0;
+};
+
+//Значение "пути нет" в constrainedDistances
+const size_t NO_CONSTRAINED_PATH = std::numeric_limits<size_t>::max();
+
+//Кратчайшие (по числу рёбер) пути из source, слово меток которых допускает automaton.
+//BFS по произведению графа и автомата за один проход: для каждой вершины хранится маска уже достигнутых
+//состояний, и вершина попадает во фронт один раз за уровень со всеми новыми состояниями сразу.
+//O((V + E) * Q), где Q - кол-во состояний. Возвращает расстояние для каждой вершины или NO_CONSTRAINED_PATH
+template <typename Vertex>
+std::vector<size_t> constrainedDistances(const LabeledGraph<Vertex>& graph, const LabelAutomaton& automaton,
+                                         VertexArg<Vertex> source) {
+    if(graph.LabelsCount() > automaton.LabelsCount()) {
+        throw std::invalid_argument("constrainedDistances: automaton does not cover all labels");
+    }
+    size_t n = graph.VerticesCount();
+    std::vector<size_t> dist(n, NO_CONSTRAINED_PATH);
+    std::vector<uint64_t> reached(n, 0);    //состояния, в которых вершина уже была
+    std::vector<uint64_t> current(n, 0);    //состояния вершины на текущем уровне
+    std::vector<uint64_t> next(n, 0);       //состояния вершины на следующем уровне
+    std::vector<Vertex> frontier{source}, nextFrontier;
+
+    reached.at(source) = current[source] = automaton.StartStates();
+    if(current[source] & automaton.AcceptingStates()) {
+        dist[source] = 0;
+    }
+    for(size_t level = 1; !frontier.empty(); ++level) {
+        for(auto from : frontier) {
+            for(const auto& e : graph.GetEdges(from)) {
+                uint64_t states = automaton.Step(current[from], e.label) & ~reached[e.to];
+                if(states == 0) {
+                    continue;
+                }
+                if(next[e.to] == 0) {
+                    nextFrontier.push_back(e.to);
+                }
+                next[e.to] |= states;
+            }
+        }
+        for(auto v : frontier) {
+            current[v] = 0;
+        }
+        for(auto v : nextFrontier) {
+            reached[v] |= next[v];
+            current[v] = next[v];
+            next[v] = 0;
+            if(dist[v] == NO_CONSTRAINED_PATH && (current[v] & automaton.AcceptingStates())) {
+                dist[v] = level;
+            }
+        }
+        frontier.swap(nextFrontier);
+        nextFrontier.clear();
+    }
+    return dist;
+}
+#endif //DSF_LABELED_GRAPH_H
@@ -0,0 +1,110 @@
+#ifndef DSF_MULTI_SOURCE_BFS_H
+#define DSF_MULTI_SOURCE_BFS_H
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "graph.h"
+#include "parallel.h"
+
+//Как обходить фронт в multiSourceBfs
+enum BfsMode {
+    SEQUENTIAL_BFS,     //обычная очередь
+    PARALLEL_BFS        //по уровням, фронт делится между потоками
+};
+
+//Результат multiSourceBfs (диаграмма Вороного на графе)
+template <typename Vertex = uint32_t>
+struct NearestSources {
+    std::vector<Vertex> dist;       //расстояние до ближайшего источника, NO_VERTEX если ни один не достижим
+    std::vector<Vertex> nearest;    //номер этого источника, NO_VERTEX если ни один не достижим
+};
+
+//Меньше стольких вершин фронта на поток в параллельном multiSourceBfs не даём
+const size_t MULTI_SOURCE_BFS_MIN_CHUNK = 1024;
+
+//BFS сразу из всех sources за один проход O(V + E) вместо k отдельных bfs.
+//Для каждой вершины находит расстояние до ближайшего источника и сам источник.
+//Если ближайших источников несколько, выбирается источник с наименьшим номером: метка вершины -
+//минимум меток соседей предыдущего уровня, а они к этому моменту уже окончательные.
+//Поэтому ответ не зависит ни от порядка sources, ни от режима и кол-ва потоков
+template <typename Vertex>
+NearestSources<Vertex> multiSourceBfs(const IGraph<Vertex>* const graph, std::vector<VertexArg<Vertex>> sources,
+                                      BfsMode mode = SEQUENTIAL_BFS,
+                                      size_t threadsCount = std::thread::hardware_concurrency()) {
+    const Vertex NO_VERTEX = VertexTraits<Vertex>::NO_VERTEX;
+    CompactAdjacency<Vertex> adjacency(graph, false);
+    size_t n = graph->VerticesCount();
+    std::sort(sources.begin(), sources.end());
+    sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+    for(auto s : sources) {
+        if(s >= n) {
+            throw std::out_of_range("multiSourceBfs: source out of range");
+        }
+    }
+
+    NearestSources<Vertex> result;
+    if(mode == SEQUENTIAL_BFS) {
+        result.dist.assign(n, NO_VERTEX);
+        result.nearest.assign(n, NO_VERTEX);
+        std::vector<Vertex> q(sources);     //вектор как очередь, голова - индекс head
+        for(auto s : sources) {
+            result.dist[s] = 0;
+            result.nearest[s] = s;
+        }
+        for(size_t head = 0; head < q.size(); ++head) {
+            Vertex from = q[head];
+            for(size_t i = adjacency.Begin(from); i < adjacency.End(from); ++i) {
+                Vertex to = adjacency.targets[i];
+                if(result.dist[to] == NO_VERTEX) {
+                    result.dist[to] = result.dist[from] + 1;
+                    result.nearest[to] = result.nearest[from];
+                    q.push_back(to);
+                } else if(result.dist[to] == result.dist[from] + 1) {
+                    result.nearest[to] = std::min(result.nearest[to], result.nearest[from]);
+                }
+            }
+        }
+        return result;
+    }
+
+    //Параллельный режим: уровень за уровнем. Вершину следующего уровня забирает тот поток,
+    //чей compare_exchange первым поменял NO_VERTEX на расстояние, а метку уменьшают все, кто до неё дошёл
+    std::vector<std::atomic<Vertex>> dist(n), nearest(n);
+    for(size_t v = 0; v < n; ++v) {
+        dist[v].store(NO_VERTEX, std::memory_order_relaxed);
+        nearest[v].store(NO_VERTEX, std::memory_order_relaxed);
+    }
+    for(auto s : sources) {
+        dist[s].store(0, std::memory_order_relaxed);
+        nearest[s].store(s, std::memory_order_relaxed);
+    }
+    std::vector<Vertex> frontier(sources);
+    for(Vertex level = 0; !frontier.empty(); ++level) {
+        auto next = parallelFrontier(frontier, threadsCount, MULTI_SOURCE_BFS_MIN_CHUNK, [&](Vertex from, std::vector<Vertex>& out) {
+            Vertex label = nearest[from].load(std::memory_order_relaxed);
+            for(size_t i = adjacency.Begin(from); i < adjacency.End(from); ++i) {
+                Vertex to = adjacency.targets[i];
+                Vertex expected = NO_VERTEX;
+                if(dist[to].compare_exchange_strong(expected, level + 1, std::memory_order_relaxed)) {
+                    out.push_back(to);
+                    atomicMin(nearest[to], label);
+                } else if(expected == level + 1) {
+                    atomicMin(nearest[to], label);
+                }
+            }
+        });
+        frontier.clear();
+        for(const auto& part : next) {
+            frontier.insert(frontier.end(), part.begin(), part.end());
+        }
+    }
+    result.dist.resize(n);
+    result.nearest.resize(n);
+    for(size_t v = 0; v < n; ++v) {
+        result.dist[v] = dist[v].load(std::memory_order_relaxed);
+        result.nearest[v] = nearest[v].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+#endif //DSF_MULTI_SOURCE_BFS_H
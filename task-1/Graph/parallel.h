@@ -0,0 +1,46 @@
+#ifndef DSF_PARALLEL_H
+#define DSF_PARALLEL_H
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+//Атомарно уменьшить value до candidate, вернёт true если получилось
+template <typename T>
+bool atomicMin(std::atomic<T>& value, typename std::atomic<T>::value_type candidate) {
+    T current = value.load(std::memory_order_relaxed);
+    while(candidate < current) {
+        if(value.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//Разбить вершины frontier на куски не меньше minChunk (не больше threadsCount кусков) и для каждой
+//вызвать visit(vertex, out), где out - локальный для потока список вершин следующего фронта.
+//minChunk отсекает маленькие фронты, на которых запуск потоков дороже самой работы
+template <typename Vertex, typename Visit>
+std::vector<std::vector<Vertex>> parallelFrontier(const std::vector<Vertex>& frontier, size_t threadsCount,
+                                                  size_t minChunk, Visit visit) {
+    minChunk = std::max<size_t>(1, minChunk);
+    threadsCount = std::max<size_t>(1, std::min(threadsCount, (frontier.size() + minChunk - 1) / minChunk));
+    std::vector<std::vector<Vertex>> out(threadsCount);
+    auto work = [&](size_t t) {
+        size_t begin = frontier.size() * t / threadsCount;
+        size_t end = frontier.size() * (t + 1) / threadsCount;
+        for(size_t i = begin; i < end; ++i) {
+            visit(frontier[i], out[t]);
+        }
+    };
+    std::vector<std::thread> threads;
+    for(size_t t = 1; t < threadsCount; ++t) {
+        threads.emplace_back(work, t);
+    }
+    work(0);
+    for(auto& th : threads) {
+        th.join();
+    }
+    return out;
+}
+#endif //DSF_PARALLEL_H
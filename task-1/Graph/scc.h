@@ -0,0 +1,403 @@
+#ifndef DSF_SCC_H
+#define DSF_SCC_H
+#include <vector>
+#include <algorithm>
+#include <queue>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <random>
+#include "graph.h"
+
+//Результат поиска компонент сильной связности
+template <typename Vertex = uint32_t>
+struct Condensation {
+    std::vector<Vertex> component;              //component[v] - номер компоненты вершины v
+    size_t componentsCount = 0;
+    //Граф конденсации: рёбра между компонентами без повторов. Номера компонент идут в топологическом
+    //порядке, то есть любое ребро dag ведёт из компоненты с меньшим номером в компоненту с большим
+    std::vector<std::vector<Vertex>> dag;
+};
+
+//Рабочие массивы TarjanScc размера V. В исходном состоянии все элементы нулевые.
+//Запуски на непересекающихся подмножествах вершин трогают непересекающиеся элементы,
+//поэтому один набор можно отдать нескольким потокам сразу. onStack - vector<char>, а не vector<bool>,
+//чтобы запись соседних элементов из разных потоков не была гонкой
+template <typename Vertex = uint32_t>
+struct TarjanArrays {
+    explicit TarjanArrays(size_t verticesCount) : index(verticesCount, 0), lowlink(verticesCount, 0), onStack(verticesCount, 0) {}
+
+    std::vector<Vertex> index, lowlink;
+    std::vector<char> onStack;
+};
+
+//Нерекурсивный алгоритм Тарьяна. Рекурсия заменена явным стеком кадров (вершина, номер следующего ребра),
+//поэтому глубина графа ограничена только памятью. Обходит только вершины, для которых inSubset вернёт true,
+//и для каждой найденной компоненты вызывает emit(вектор её вершин). Компоненты выдаются в обратном топологическом порядке.
+//Массивы arrays после Run возвращаются в исходное состояние, так что один объект можно много раз
+//запускать на маленьких подмножествах, а несколько объектов с общими arrays - параллельно на непересекающихся
+template <typename Vertex = uint32_t>
+class TarjanScc {
+public:
+    TarjanScc(const CompactAdjacency<Vertex>& adjacency, TarjanArrays<Vertex>& arrays)
+        : adjacency(adjacency), index(arrays.index), lowlink(arrays.lowlink), onStack(arrays.onStack) {}
+
+    template <typename InSubset, typename Emit>
+    void Run(const std::vector<Vertex>& vertices, InSubset inSubset, Emit emit) {
+        Vertex counter = 0;     //номера обхода начинаются с 1, 0 значит что вершина ещё не посещена
+        for(auto root : vertices) {
+            if(index[root] != 0) {
+                continue;
+            }
+            Visit(root, counter);
+            while(!callStack.empty()) {
+                Frame& frame = callStack.back();
+                Vertex vertex = frame.vertex;
+                if(frame.next < adjacency.End(vertex)) {
+                    Vertex to = adjacency.targets[frame.next++];
+                    if(!inSubset(to)) {
+                        continue;
+                    }
+                    if(index[to] == 0) {
+                        Visit(to, counter);     //аналог рекурсивного вызова, frame после этого использовать нельзя
+                    } else if(onStack[to]) {
+                        lowlink[vertex] = std::min(lowlink[vertex], index[to]);
+                    }
+                    continue;
+                }
+                //все рёбра вершины просмотрены - аналог выхода из рекурсии
+                callStack.pop_back();
+                if(!callStack.empty()) {
+                    Vertex parent = callStack.back().vertex;
+                    lowlink[parent] = std::min(lowlink[parent], lowlink[vertex]);
+                }
+                if(lowlink[vertex] == index[vertex]) {
+                    std::vector<Vertex> component;
+                    Vertex top;
+                    do {
+                        top = sccStack.back();
+                        sccStack.pop_back();
+                        onStack[top] = 0;
+                        component.push_back(top);
+                    } while(top != vertex);
+                    emit(component);
+                }
+            }
+        }
+        for(auto v : vertices) {
+            index[v] = 0;
+        }
+    }
+private:
+    struct Frame {
+        Vertex vertex;
+        size_t next;    //позиция следующего непросмотренного ребра в adjacency.targets
+    };
+
+    void Visit(Vertex vertex, Vertex& counter) {
+        index[vertex] = lowlink[vertex] = ++counter;
+        sccStack.push_back(vertex);
+        onStack[vertex] = 1;
+        callStack.push_back({vertex, adjacency.Begin(vertex)});
+    }
+
+    const CompactAdjacency<Vertex>& adjacency;
+    std::vector<Vertex>& index;
+    std::vector<Vertex>& lowlink;
+    std::vector<char>& onStack;
+    std::vector<Vertex> sccStack;
+    std::vector<Frame> callStack;
+};
+
+//По произвольной нумерации компонент строит граф конденсации и перенумеровывает компоненты
+//в топологическом порядке (алгоритм Кана)
+template <typename Vertex>
+Condensation<Vertex> condense(const CompactAdjacency<Vertex>& adjacency, std::vector<Vertex> component, size_t componentsCount) {
+    size_t n = component.size();
+    std::vector<std::vector<Vertex>> dag(componentsCount);
+    for(Vertex from = 0; from < n; ++from) {
+        for(size_t i = adjacency.Begin(from); i < adjacency.End(from); ++i) {
+            Vertex to = adjacency.targets[i];
+            if(component[from] != component[to]) {
+                dag[component[from]].push_back(component[to]);
+            }
+        }
+    }
+    std::vector<size_t> inDegree(componentsCount, 0);
+    for(auto& edges : dag) {
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        for(auto to : edges) {
+            ++inDegree[to];
+        }
+    }
+    std::queue<Vertex> q;
+    for(Vertex c = 0; c < componentsCount; ++c) {
+        if(inDegree[c] == 0) {
+            q.push(c);
+        }
+    }
+    std::vector<Vertex> order(componentsCount);     //order[старый номер] = новый номер
+    Vertex next = 0;
+    while(!q.empty()) {
+        Vertex c = q.front();
+        q.pop();
+        order[c] = next++;
+        for(auto to : dag[c]) {
+            if(--inDegree[to] == 0) {
+                q.push(to);
+            }
+        }
+    }
+
+    Condensation<Vertex> result;
+    result.componentsCount = componentsCount;
+    result.dag.resize(componentsCount);
+    for(Vertex c = 0; c < componentsCount; ++c) {
+        for(auto to : dag[c]) {
+            result.dag[order[c]].push_back(order[to]);
+        }
+        std::sort(result.dag[order[c]].begin(), result.dag[order[c]].end());
+    }
+    for(auto& c : component) {
+        c = order[c];
+    }
+    result.component = std::move(component);
+    return result;
+}
+
+//Компоненты сильной связности орграфа за O(V + E) без рекурсии
+template <typename Vertex>
+Condensation<Vertex> stronglyConnectedComponents(const IGraph<Vertex>* const graph) {
+    CompactAdjacency<Vertex> adjacency(graph, false);
+    size_t n = graph->VerticesCount();
+    std::vector<Vertex> vertices(n);
+    for(Vertex v = 0; v < n; ++v) {
+        vertices[v] = v;
+    }
+    std::vector<Vertex> component(n);
+    Vertex componentsCount = 0;
+    TarjanArrays<Vertex> arrays(n);
+    TarjanScc<Vertex>(adjacency, arrays).Run(vertices, [](Vertex) { return true; }, [&](const std::vector<Vertex>& vs) {
+        for(auto v : vs) {
+            component[v] = componentsCount;
+        }
+        ++componentsCount;
+    });
+    return condense(adjacency, std::move(component), componentsCount);
+}
+
+//Параллельный forward-backward алгоритм. Множество вершин с общим цветом - независимая задача.
+//Сначала задачу подрезаем: вершина без входящих или без исходящих рёбер внутри задачи - сама себе компонента,
+//такие вершины снимаются, пока они есть. Так за один линейный проход уходят цепочки, деревья и прочие ациклические куски.
+//Затем берём случайную опорную вершину, ищем достижимые из неё (F) и ведущие в неё (B) вершины этого цвета,
+//F ∩ B - компонента, а F \ B, B \ F и остаток - три новые независимые задачи, которые разбирают свободные потоки.
+//Задачи меньше smallTask вершин доделываются последовательным Тарьяном. Им же доделывается часть,
+//в которой осталось больше 7/8 задачи: тогда каждый шаг forward-backward уменьшает задачи хотя бы на восьмую часть,
+//глубина разбиения O(log V) и всего работы O((V + E) log V) даже на неудачных графах
+template <typename Vertex>
+Condensation<Vertex> parallelStronglyConnectedComponents(const IGraph<Vertex>* const graph,
+                                                 size_t threadsCount = std::thread::hardware_concurrency(),
+                                                 size_t smallTask = 4096) {
+    CompactAdjacency<Vertex> forward(graph, false);
+    CompactAdjacency<Vertex> backward(graph, true);
+    size_t n = graph->VerticesCount();
+    threadsCount = std::max<size_t>(1, threadsCount);
+
+    //цвет вершины - номер задачи, в которой она сейчас лежит. Каждую вершину пишет только поток,
+    //владеющий её задачей, но соседей из чужих задач читают все, поэтому цвета атомарные.
+    //Задач может быть больше, чем вершин, поэтому цвет - size_t, а не Vertex
+    std::vector<std::atomic<size_t>> colors(n);
+    for(auto& c : colors) {
+        c.store(0, std::memory_order_relaxed);
+    }
+    std::atomic<size_t> nextColor(1);
+    std::vector<Vertex> component(n);
+    std::atomic<Vertex> componentsCount(0);
+    //Задачи не пересекаются по вершинам, поэтому рабочие массивы Тарьяна и счётчики степеней
+    //для подрезки общие на все потоки: элемент вершины трогает только владелец её задачи
+    TarjanArrays<Vertex> tarjanArrays(n);
+    std::vector<size_t> inDegree(n), outDegree(n);     //size_t: с кратными рёбрами степень может не влезть в Vertex
+
+    struct Task {
+        size_t color;
+        std::vector<Vertex> vertices;
+        bool serial;        //доделать Тарьяном, не разбивая
+    };
+    std::vector<Task> tasks;
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t active = 0;      //кол-во задач, которые сейчас обрабатываются
+
+    std::vector<Vertex> all(n);
+    for(Vertex v = 0; v < n; ++v) {
+        all[v] = v;
+    }
+    if(n > 0) {
+        tasks.push_back({0, std::move(all), false});
+    }
+
+    auto colorOf = [&](Vertex v) {
+        return colors[v].load(std::memory_order_relaxed);
+    };
+    auto paint = [&](Vertex v, size_t color) {
+        colors[v].store(color, std::memory_order_relaxed);
+    };
+    //кол-во соседей v цвета c без петли в v
+    auto degree = [&](const CompactAdjacency<Vertex>& adjacency, Vertex v, size_t c) {
+        size_t result = 0;
+        for(size_t i = adjacency.Begin(v); i < adjacency.End(v); ++i) {
+            Vertex to = adjacency.targets[i];
+            result += to != v && colorOf(to) == c;
+        }
+        return result;
+    };
+
+    //Снять из задачи вершины без входящих или исходящих рёбер внутри неё, каждая - отдельная компонента
+    auto trim = [&](Task& task) {
+        size_t c = task.color;
+        size_t trimmedColor = nextColor.fetch_add(1);
+        for(auto v : task.vertices) {
+            inDegree[v] = degree(backward, v, c);
+            outDegree[v] = degree(forward, v, c);
+        }
+        std::vector<Vertex> trimmed;    //вектор как очередь, вершина красится в trimmedColor при добавлении
+        for(auto v : task.vertices) {
+            if(inDegree[v] == 0 || outDegree[v] == 0) {
+                paint(v, trimmedColor);
+                trimmed.push_back(v);
+            }
+        }
+        for(size_t head = 0; head < trimmed.size(); ++head) {
+            Vertex v = trimmed[head];
+            for(size_t i = forward.Begin(v); i < forward.End(v); ++i) {
+                Vertex to = forward.targets[i];
+                if(colorOf(to) == c && --inDegree[to] == 0) {
+                    paint(to, trimmedColor);
+                    trimmed.push_back(to);
+                }
+            }
+            for(size_t i = backward.Begin(v); i < backward.End(v); ++i) {
+                Vertex to = backward.targets[i];
+                if(colorOf(to) == c && --outDegree[to] == 0) {
+                    paint(to, trimmedColor);
+                    trimmed.push_back(to);
+                }
+            }
+        }
+        if(trimmed.empty()) {
+            return;
+        }
+        Vertex first = componentsCount.fetch_add(static_cast<Vertex>(trimmed.size()));
+        for(size_t i = 0; i < trimmed.size(); ++i) {
+            component[trimmed[i]] = static_cast<Vertex>(first + i);
+        }
+        task.vertices.erase(std::remove_if(task.vertices.begin(), task.vertices.end(), [&](Vertex v) {
+            return colorOf(v) != c;
+        }), task.vertices.end());
+    };
+
+    auto process = [&](Task task, TarjanScc<Vertex>& tarjan, std::mt19937& gen) {
+        size_t c = task.color;
+        if(!task.serial && task.vertices.size() > smallTask) {
+            trim(task);
+        }
+        if(task.serial || task.vertices.size() <= smallTask) {
+            tarjan.Run(task.vertices, [&](Vertex v) { return colorOf(v) == c; }, [&](const std::vector<Vertex>& vs) {
+                Vertex id = componentsCount.fetch_add(1);
+                for(auto v : vs) {
+                    component[v] = id;
+                }
+            });
+            return;
+        }
+        Vertex pivot = task.vertices[std::uniform_int_distribution<size_t>(0, task.vertices.size() - 1)(gen)];
+        size_t forwardColor = nextColor.fetch_add(1);
+        size_t backwardColor = nextColor.fetch_add(1);
+        size_t sccColor = nextColor.fetch_add(1);
+
+        std::vector<Vertex> stack{pivot};
+        paint(pivot, forwardColor);
+        while(!stack.empty()) {
+            Vertex from = stack.back();
+            stack.pop_back();
+            for(size_t i = forward.Begin(from); i < forward.End(from); ++i) {
+                Vertex to = forward.targets[i];
+                if(colorOf(to) == c) {
+                    paint(to, forwardColor);
+                    stack.push_back(to);
+                }
+            }
+        }
+        stack.push_back(pivot);
+        paint(pivot, sccColor);
+        while(!stack.empty()) {
+            Vertex from = stack.back();
+            stack.pop_back();
+            for(size_t i = backward.Begin(from); i < backward.End(from); ++i) {
+                Vertex to = backward.targets[i];
+                size_t color = colorOf(to);
+                if(color == forwardColor || color == c) {
+                    paint(to, color == forwardColor ? sccColor : backwardColor);
+                    stack.push_back(to);
+                }
+            }
+        }
+
+        Task forwardOnly{forwardColor, {}, false}, backwardOnly{backwardColor, {}, false}, rest{c, {}, false};
+        Vertex id = componentsCount.fetch_add(1);
+        for(auto v : task.vertices) {
+            size_t color = colorOf(v);
+            if(color == sccColor) {
+                component[v] = id;
+            } else if(color == forwardColor) {
+                forwardOnly.vertices.push_back(v);
+            } else if(color == backwardColor) {
+                backwardOnly.vertices.push_back(v);
+            } else {
+                rest.vertices.push_back(v);
+            }
+        }
+        size_t largeChild = task.vertices.size() - task.vertices.size() / 8;
+        std::lock_guard<std::mutex> lock(mutex);
+        for(Task* t : {&forwardOnly, &backwardOnly, &rest}) {
+            if(!t->vertices.empty()) {
+                t->serial = t->vertices.size() > largeChild;
+                tasks.push_back(std::move(*t));
+            }
+        }
+        cv.notify_all();
+    };
+
+    auto worker = [&](size_t index) {
+        TarjanScc<Vertex> tarjan(forward, tarjanArrays);
+        std::mt19937 gen(static_cast<uint32_t>(index));
+        std::unique_lock<std::mutex> lock(mutex);
+        while(true) {
+            cv.wait(lock, [&] { return !tasks.empty() || active == 0; });
+            if(tasks.empty()) {
+                return;     //задач нет и никто не может добавить новые
+            }
+            Task task = std::move(tasks.back());
+            tasks.pop_back();
+            ++active;
+            lock.unlock();
+            process(std::move(task), tarjan, gen);
+            lock.lock();
+            if(--active == 0 && tasks.empty()) {
+                cv.notify_all();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for(size_t t = 1; t < threadsCount; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for(auto& th : threads) {
+        th.join();
+    }
+    return condense(forward, std::move(component), componentsCount.load());
+}
+#endif //DSF_SCC_H
@@ -0,0 +1,138 @@
+#ifndef DSF_TRANSITIVE_CLOSURE_H
+#define DSF_TRANSITIVE_CLOSURE_H
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include "graph.h"
+
+//Простой переиспользуемый барьер: потоки ждут, пока до него не дойдут все threadsCount потоков
+class Barrier {
+public:
+    Barrier(size_t threadsCount) : threadsCount(threadsCount) {}
+
+    void Wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        size_t currentGeneration = generation;
+        if(++arrived == threadsCount) {
+            arrived = 0;
+            ++generation;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [&] { return generation != currentGeneration; });
+        }
+    }
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t threadsCount;
+    size_t arrived = 0;
+    size_t generation = 0;
+};
+
+//Транзитивное замыкание орграфа (обычно MatrixGraph) на упакованных битовых строках.
+//Строка v - битовая маска вершин, достижимых из v путём хотя бы из одного ребра.
+//Считается алгоритмом Уоршелла: на шаге k к каждой строке, где стоит бит k, прибавляется (OR) строка k
+//по 64 вершины за операцию. Строки делятся на блоки между потоками, между шагами потоки ждут на барьере.
+//Время O(V^3 / 64), память V^2 / 8 байт
+class TransitiveClosure {
+public:
+    template <typename Vertex>
+    TransitiveClosure(const IGraph<Vertex>* const graph, size_t threadsCount = std::thread::hardware_concurrency())
+        : verticesCount(graph->VerticesCount()),
+          wordsPerRow((verticesCount + 63) / 64),
+          bits(verticesCount * wordsPerRow, 0) {
+        for(Vertex from = 0; from < verticesCount; ++from) {
+            for(auto to : graph->GetVertices(from)) {
+                Set(from, to);
+            }
+        }
+        Warshall(std::max<size_t>(1, std::min(threadsCount, verticesCount)));
+    }
+
+    //Есть ли путь из from в to. Вершина всегда достижима сама из себя. O(1)
+    bool Reachable(size_t from, size_t to) const {
+        return from == to || Test(from, to);
+    }
+
+    //Лежит ли вершина на цикле (достижима сама из себя хотя бы по одному ребру)
+    bool OnCycle(size_t vertex) const {
+        return Test(vertex, vertex);
+    }
+
+    //Есть ли в графе цикл - побочный результат замыкания, ответ тот же что у hasCycle
+    bool HasCycle() const {
+        for(size_t v = 0; v < verticesCount; ++v) {
+            if(OnCycle(v)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //Кол-во вершин, достижимых из vertex (не считая её саму, если она не на цикле)
+    size_t ReachableCount(size_t vertex) const {
+        size_t result = 0;
+        const uint64_t* row = Row(vertex);
+        for(size_t w = 0; w < wordsPerRow; ++w) {
+            result += __builtin_popcountll(row[w]);
+        }
+        return result;
+    }
+
+    size_t VerticesCount() const {
+        return verticesCount;
+    }
+private:
+    uint64_t* Row(size_t vertex) {
+        return bits.data() + vertex * wordsPerRow;
+    }
+
+    const uint64_t* Row(size_t vertex) const {
+        return bits.data() + vertex * wordsPerRow;
+    }
+
+    void Set(size_t from, size_t to) {
+        Row(from)[to / 64] |= uint64_t(1) << (to % 64);
+    }
+
+    bool Test(size_t from, size_t to) const {
+        return (Row(from)[to / 64] >> (to % 64)) & 1;
+    }
+
+    void Warshall(size_t threadsCount) {
+        Barrier barrier(threadsCount);
+        //строка k на шаге k не меняется (OR с самой собой), поэтому её можно читать всем потокам без блокировок
+        auto work = [&](size_t t) {
+            size_t begin = verticesCount * t / threadsCount;
+            size_t end = verticesCount * (t + 1) / threadsCount;
+            for(size_t k = 0; k < verticesCount; ++k) {
+                const uint64_t* rowK = Row(k);
+                for(size_t i = begin; i < end; ++i) {
+                    if(i != k && Test(i, k)) {
+                        uint64_t* rowI = Row(i);
+                        for(size_t w = 0; w < wordsPerRow; ++w) {
+                            rowI[w] |= rowK[w];
+                        }
+                    }
+                }
+                barrier.Wait();
+            }
+        };
+        std::vector<std::thread> threads;
+        for(size_t t = 1; t < threadsCount; ++t) {
+            threads.emplace_back(work, t);
+        }
+        work(0);
+        for(auto& th : threads) {
+            th.join();
+        }
+    }
+
+    size_t verticesCount;
+    size_t wordsPerRow;
+    std::vector<uint64_t> bits;     //матрица verticesCount x wordsPerRow слов, строки подряд
+};
+#endif //DSF_TRANSITIVE_CLOSURE_H
@@ -0,0 +1,34 @@
+#ifndef DSF_VERTEX_H
+#define DSF_VERTEX_H
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+//Проверка типа номера вершины при компиляции. Номер вершины - беззнаковое целое,
+//по умолчанию uint32_t: графов больше 4 млрд вершин у нас нет, а список смежности становится вдвое меньше
+template <typename Vertex>
+struct VertexTraits {
+    static_assert(std::is_integral<Vertex>::value && std::is_unsigned<Vertex>::value,
+                  "Vertex must be an unsigned integer type");
+    static_assert(sizeof(Vertex) <= sizeof(size_t), "Vertex must not be wider than size_t");
+
+    using Type = Vertex;
+
+    //Значение "нет вершины". Поэтому в графе может быть не больше max() вершин
+    static constexpr Vertex NO_VERTEX = std::numeric_limits<Vertex>::max();
+
+    //Кол-во вершин известно только при выполнении, поэтому его проверяем в конструкторах графов
+    static size_t CheckVerticesCount(size_t verticesCount) {
+        if(verticesCount > static_cast<size_t>(NO_VERTEX)) {
+            throw std::length_error("too many vertices for this Vertex type");
+        }
+        return verticesCount;
+    }
+};
+
+//Тип параметра-вершины в алгоритмах. Тип вершины выводится только из графа,
+//поэтому можно писать bfs(&graph, 0) без приведения 0 к uint32_t
+template <typename Vertex>
+using VertexArg = typename VertexTraits<Vertex>::Type;
+#endif //DSF_VERTEX_H
@@ -0,0 +1,316 @@
+#ifndef DSF_WEIGHTED_GRAPH_H
+#define DSF_WEIGHTED_GRAPH_H
+#include <vector>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <atomic>
+#include <thread>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+#include "vertex.h"
+#include "parallel.h"
+
+//Вес ребра - целое неотрицательное число (например задержка в микросекундах)
+using Weight = uint32_t;
+//Расстояние храним в 64 битах, чтобы сумма весов по пути не переполнялась
+using Distance = uint64_t;
+//Расстояние до недостижимой вершины
+const Distance INF_DISTANCE = std::numeric_limits<Distance>::max();
+
+//Взвешенное ребро: куда ведёт и сколько стоит. С 32-битными номерами вершин ребро занимает 8 байт вместо 16
+template <typename Vertex = uint32_t>
+struct WeightedEdge {
+    Vertex to;
+    Weight weight;
+};
+
+//Непрерывный кусок массива рёбер, выходящих из одной вершины. Ничего не копирует
+template <typename Vertex = uint32_t>
+struct EdgeRange {
+    const WeightedEdge<Vertex>* first;
+    const WeightedEdge<Vertex>* last;
+
+    const WeightedEdge<Vertex>* begin() const { return first; }
+    const WeightedEdge<Vertex>* end() const { return last; }
+    size_t size() const { return last - first; }
+};
+
+template <typename Vertex = uint32_t>
+class IWeightedGraph {  //Интерфейс взвешенного орграфа, аналог IGraph
+public:
+    using VertexType = Vertex;
+
+    virtual ~IWeightedGraph() {}
+
+    //Добавить ребро из вершины from в вершину to с весом weight
+    virtual void AddEdge(Vertex from, Vertex to, Weight weight) = 0;
+
+    //получить кол-во вершин в графе
+    virtual size_t VerticesCount() const = 0;
+
+    //Получить все рёбра, выходящие из вершины vertex. В отличие от IGraph::GetVertices вектор не создаётся
+    virtual EdgeRange<Vertex> GetEdges(Vertex vertex) const = 0;
+};
+
+//Взвешенный орграф в формате CSR (compressed sparse row):
+//рёбра всех вершин лежат подряд в одном массиве, offsets[v]..offsets[v+1] - рёбра вершины v.
+//Рёбра сначала копятся через AddEdge, потом один раз упаковываются вызовом Build()
+template <typename Vertex = uint32_t>
+class CSRGraph : public IWeightedGraph<Vertex> {
+public:
+    CSRGraph(size_t verticesCount)
+        : verticesCount(VertexTraits<Vertex>::CheckVerticesCount(verticesCount)), offsets(verticesCount + 1, 0) {}
+
+    void AddEdge(Vertex from, Vertex to, Weight weight) override {
+        if(from >= verticesCount || to >= verticesCount) {
+            throw std::out_of_range("CSRGraph::AddEdge: vertex out of range");
+        }
+        pending.push_back({from, {to, weight}});
+        built = false;
+    }
+
+    size_t VerticesCount() const override {
+        return verticesCount;
+    }
+
+    EdgeRange<Vertex> GetEdges(Vertex vertex) const override {
+        if(!built) {
+            throw std::logic_error("CSRGraph::GetEdges: call Build() after adding edges");
+        }
+        const WeightedEdge<Vertex>* data = edges.data();
+        return {data + offsets.at(vertex), data + offsets.at(vertex + 1)};
+    }
+
+    //Упаковать добавленные рёбра сортировкой подсчётом по начальной вершине, O(V + E)
+    void Build() {
+        //старые рёбра тоже участвуют, чтобы можно было дозагружать граф порциями
+        for(Vertex v = 0; v < verticesCount; ++v) {
+            for(size_t i = offsets[v]; i < offsets[v + 1]; ++i) {
+                pending.push_back({v, edges[i]});
+            }
+        }
+        std::vector<size_t> newOffsets(verticesCount + 1, 0);
+        for(const auto& e : pending) {
+            ++newOffsets[e.from + 1];
+        }
+        for(size_t v = 0; v < verticesCount; ++v) {
+            newOffsets[v + 1] += newOffsets[v];
+        }
+        std::vector<WeightedEdge<Vertex>> newEdges(pending.size());
+        std::vector<size_t> position(newOffsets.begin(), newOffsets.end() - 1);
+        for(const auto& e : pending) {
+            newEdges[position[e.from]++] = e.edge;
+        }
+        offsets.swap(newOffsets);
+        edges.swap(newEdges);
+        pending.clear();
+        pending.shrink_to_fit();
+        built = true;
+    }
+
+    size_t EdgesCount() const {
+        return edges.size() + pending.size();
+    }
+private:
+    struct PendingEdge {
+        Vertex from;
+        WeightedEdge<Vertex> edge;
+    };
+
+    size_t verticesCount;
+    std::vector<size_t> offsets;        //verticesCount + 1 элементов
+    std::vector<WeightedEdge<Vertex>> edges;    //все рёбра, отсортированные по начальной вершине
+    std::vector<PendingEdge> pending;   //рёбра, добавленные после последнего Build()
+    bool built = true;
+};
+
+//0-1 BFS: кратчайшие расстояния от start, когда все веса равны 0 или 1. O(V + E).
+//Рёбра веса 0 кладём в начало дека, веса 1 - в конец, так дек всегда отсортирован по расстоянию
+template <typename Vertex>
+std::vector<Distance> zeroOneBfs(const IWeightedGraph<Vertex>* const graph, VertexArg<Vertex> start) {
+    std::vector<Distance> dist(graph->VerticesCount(), INF_DISTANCE);
+    std::deque<Vertex> dq;
+    dist.at(start) = 0;
+    dq.push_back(start);
+    while(!dq.empty()) {
+        Vertex from = dq.front();
+        dq.pop_front();
+        for(const auto& e : graph->GetEdges(from)) {
+            if(e.weight > 1) {
+                throw std::invalid_argument("zeroOneBfs: edge weight must be 0 or 1");
+            }
+            if(dist[from] + e.weight < dist[e.to]) {
+                dist[e.to] = dist[from] + e.weight;
+                if(e.weight == 0) {
+                    dq.push_front(e.to);
+                } else {
+                    dq.push_back(e.to);
+                }
+            }
+        }
+    }
+    return dist;
+}
+
+//Монотонная radix-куча: извлекаемые ключи не убывают, поэтому элементы раскладываются
+//по корзинам по номеру старшего бита, в котором ключ отличается от последнего извлечённого.
+//Каждый элемент переезжает в корзину с меньшим номером не больше 64 раз
+template <typename Vertex = uint32_t>
+class RadixHeap {
+public:
+    void Push(Distance key, Vertex vertex) {
+        buckets[BucketIndex(key)].push_back({key, vertex});
+        ++count;
+    }
+
+    bool Empty() const {
+        return count == 0;
+    }
+
+    //Достать элемент с минимальным ключом
+    std::pair<Distance, Vertex> Pop() {
+        if(buckets[0].empty()) {
+            size_t i = 1;
+            while(buckets[i].empty()) {
+                ++i;
+            }
+            //новый минимум - наименьший ключ в первой непустой корзине, перераскладываем её
+            Distance newLast = buckets[i][0].first;
+            for(const auto& item : buckets[i]) {
+                newLast = std::min(newLast, item.first);
+            }
+            last = newLast;
+            for(const auto& item : buckets[i]) {
+                buckets[BucketIndex(item.first)].push_back(item);
+            }
+            buckets[i].clear();
+        }
+        auto result = buckets[0].back();
+        buckets[0].pop_back();
+        --count;
+        return result;
+    }
+private:
+    size_t BucketIndex(Distance key) const {
+        return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+    }
+
+    std::vector<std::pair<Distance, Vertex>> buckets[65];
+    Distance last = 0;
+    size_t count = 0;
+};
+
+//Дейкстра на radix-куче для целых весов, O(E + V log C), где C - максимальный вес
+template <typename Vertex>
+std::vector<Distance> dijkstraRadixHeap(const IWeightedGraph<Vertex>* const graph, VertexArg<Vertex> start) {
+    std::vector<Distance> dist(graph->VerticesCount(), INF_DISTANCE);
+    RadixHeap<Vertex> heap;
+    dist.at(start) = 0;
+    heap.Push(0, start);
+    while(!heap.Empty()) {
+        auto top = heap.Pop();
+        Vertex from = top.second;
+        if(top.first != dist[from]) {
+            continue;   //устаревшая запись, вершину уже достали с меньшим расстоянием
+        }
+        for(const auto& e : graph->GetEdges(from)) {
+            if(dist[from] + e.weight < dist[e.to]) {
+                dist[e.to] = dist[from] + e.weight;
+                heap.Push(dist[e.to], e.to);
+            }
+        }
+    }
+    return dist;
+}
+
+//Меньше стольких вершин фронта на поток в deltaStepping не даём
+const size_t DELTA_STEPPING_MIN_CHUNK = 256;
+
+//Параллельный delta-stepping. Вершины лежат в корзинах ширины delta по расстоянию.
+//Корзины обрабатываются по возрастанию: лёгкие рёбра (вес <= delta) релаксируются, пока корзина
+//не опустеет, затем один раз релаксируются тяжёлые рёбра всех вершин, удалённых из корзины.
+//Релаксации внутри фазы идут параллельно по threadsCount потокам
+template <typename Vertex>
+std::vector<Distance> deltaStepping(const IWeightedGraph<Vertex>* const graph, VertexArg<Vertex> start, Weight delta,
+                                    size_t threadsCount = std::thread::hardware_concurrency()) {
+    if(delta == 0) {
+        throw std::invalid_argument("deltaStepping: delta must be positive");
+    }
+    size_t n = graph->VerticesCount();
+    std::vector<std::atomic<Distance>> dist(n);
+    for(auto& d : dist) {
+        d.store(INF_DISTANCE, std::memory_order_relaxed);
+    }
+    dist.at(start).store(0, std::memory_order_relaxed);
+
+    std::map<Distance, std::vector<Vertex>> buckets;    //храним только непустые корзины
+    buckets[0].push_back(start);
+    std::vector<size_t> stamp(n, 0);    //защита от повторов вершины внутри одного фронта
+    size_t phase = 0;
+
+    //разложить вершины, у которых уменьшилось расстояние, по корзинам
+    auto distribute = [&](const std::vector<std::vector<Vertex>>& updated) {
+        ++phase;
+        for(const auto& part : updated) {
+            for(Vertex v : part) {
+                if(stamp[v] != phase) {
+                    stamp[v] = phase;
+                    buckets[dist[v].load(std::memory_order_relaxed) / delta].push_back(v);
+                }
+            }
+        }
+    };
+
+    while(!buckets.empty()) {
+        Distance index = buckets.begin()->first;
+        std::vector<Vertex> removed;
+        while(buckets.count(index)) {
+            std::vector<Vertex> frontier;
+            frontier.swap(buckets[index]);
+            buckets.erase(index);
+            //в корзине могли остаться вершины, которые с тех пор переехали в корзину пониже
+            ++phase;
+            frontier.erase(std::remove_if(frontier.begin(), frontier.end(), [&](Vertex v) {
+                if(stamp[v] == phase || dist[v].load(std::memory_order_relaxed) / delta != index) {
+                    return true;
+                }
+                stamp[v] = phase;
+                return false;
+            }), frontier.end());
+            removed.insert(removed.end(), frontier.begin(), frontier.end());
+            distribute(parallelFrontier(frontier, threadsCount, DELTA_STEPPING_MIN_CHUNK, [&](Vertex from, std::vector<Vertex>& out) {
+                Distance base = dist[from].load(std::memory_order_relaxed);
+                for(const auto& e : graph->GetEdges(from)) {
+                    if(e.weight <= delta && atomicMin(dist[e.to], base + e.weight)) {
+                        out.push_back(e.to);
+                    }
+                }
+            }));
+        }
+        ++phase;
+        removed.erase(std::remove_if(removed.begin(), removed.end(), [&](Vertex v) {
+            if(stamp[v] == phase) {
+                return true;
+            }
+            stamp[v] = phase;
+            return false;
+        }), removed.end());
+        distribute(parallelFrontier(removed, threadsCount, DELTA_STEPPING_MIN_CHUNK, [&](Vertex from, std::vector<Vertex>& out) {
+            Distance base = dist[from].load(std::memory_order_relaxed);
+            for(const auto& e : graph->GetEdges(from)) {
+                if(e.weight > delta && atomicMin(dist[e.to], base + e.weight)) {
+                    out.push_back(e.to);
+                }
+            }
+        }));
+    }
+
+    std::vector<Distance> result(n);
+    for(size_t v = 0; v < n; ++v) {
+        result[v] = dist[v].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+#endif //DSF_WEIGHTED_GRAPH_H